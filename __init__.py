@@ -1,4 +1,4 @@
-from .vita_loader import sweep_before_load
+from .vita_loader import sweep_before_load, reinject_symbols
 from binaryninja import PluginCommand
 
 PluginCommand.register(
@@ -6,3 +6,9 @@ PluginCommand.register(
     "Injects resolved NID symbols into the ARMv7 BinaryView.",
     sweep_before_load
 )
+
+PluginCommand.register(
+    "VitaELF: Re-inject Symbols (incremental)",
+    "Re-resolves against an updated NID DB, only touching changed symbols. Skips the sweep phase.",
+    reinject_symbols
+)
@@ -0,0 +1,126 @@
+"""
+Reproducible benchmark harness for the loader pipeline (headless BN).
+
+Run the full pipeline against a set of reference Vita ELFs and record
+per-phase wall time, BN analysis/sweep time, and peak RSS:
+
+    python3 benchmark.py run out.json --db merged-vita-nid-db.yml \
+        --headers vita_headers.hpp ref1.elf ref2.elf ...
+
+Diff two recorded runs (e.g. before/after a vita_loader.py change):
+
+    python3 benchmark.py compare before.json after.json
+
+Phase timings come from the same timed_phase instrumentation the plugin
+reports at the end of every load, so benchmark numbers match what users see.
+"""
+import argparse
+import importlib
+import json
+import os
+import resource
+import sys
+import time
+
+_plugin_dir = os.path.dirname(os.path.abspath(__file__))
+
+
+def _import_plugin(module):
+    sys.path.insert(0, os.path.dirname(_plugin_dir))
+    return importlib.import_module(f"{os.path.basename(_plugin_dir)}.{module}")
+
+
+def peak_rss_bytes():
+    #ru_maxrss is KiB on Linux, bytes on macOS
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return rss if sys.platform == "darwin" else rss * 1024
+
+
+def bench_module(path, db_path, header_path):
+    """
+    Run sweep + load_vita_symbols on one reference ELF and return its metrics.
+    """
+    import binaryninja
+    vita_loader = _import_plugin("vita_loader")
+
+    t0 = time.perf_counter()
+    bv = binaryninja.load(path)
+    if bv is None:
+        return {"module": path, "error": "failed to load BinaryView"}
+    try:
+        vita = vita_loader.VitaElf(bv, nid_db_path=db_path, header_path=header_path)
+        sweep_t0 = time.perf_counter()
+        vita_loader.run_linear_sweeps(bv, vita)
+        sweep_seconds = time.perf_counter() - sweep_t0
+        vita.load_vita_symbols()
+        return {
+            "module": path,
+            "total_seconds": time.perf_counter() - t0,
+            "sweep_seconds": sweep_seconds,
+            "phase_seconds": vita.phase_times,
+            "stats": vita.stats,
+            "functions": len(list(bv.functions)),
+        }
+    finally:
+        bv.file.close()
+
+
+def cmd_run(args):
+    results = {"runs": [], "peak_rss_bytes": 0}
+    for path in args.modules:
+        print(f"benchmarking {path}...")
+        results["runs"].append(bench_module(path, args.db, args.headers))
+    results["peak_rss_bytes"] = peak_rss_bytes()
+    with open(args.out, "w") as f:
+        json.dump(results, f, indent=2)
+    print(f"wrote {args.out} (peak RSS {results['peak_rss_bytes'] / 1048576:.1f} MiB)")
+    return 0
+
+
+def cmd_compare(args):
+    with open(args.before) as f:
+        before = json.load(f)
+    with open(args.after) as f:
+        after = json.load(f)
+
+    before_runs = {r["module"]: r for r in before["runs"] if "error" not in r}
+    for run in after["runs"]:
+        base = before_runs.get(run.get("module"))
+        if base is None or "error" in run:
+            continue
+        print(f"\n{run['module']}:")
+        print(f"  total: {base['total_seconds']:.2f}s -> {run['total_seconds']:.2f}s "
+              f"({run['total_seconds'] - base['total_seconds']:+.2f}s)")
+        print(f"  sweep: {base['sweep_seconds']:.2f}s -> {run['sweep_seconds']:.2f}s")
+        phases = set(base["phase_seconds"]) | set(run["phase_seconds"])
+        for phase in sorted(phases):
+            b = base["phase_seconds"].get(phase, 0.0)
+            a = run["phase_seconds"].get(phase, 0.0)
+            print(f"  {phase}: {b * 1000:.1f}ms -> {a * 1000:.1f}ms ({(a - b) * 1000:+.1f}ms)")
+    print(f"\npeak RSS: {before['peak_rss_bytes'] / 1048576:.1f} MiB -> "
+          f"{after['peak_rss_bytes'] / 1048576:.1f} MiB")
+    return 0
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Benchmark the Vita loader pipeline")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    run_p = sub.add_parser("run", help="benchmark the pipeline against reference ELFs")
+    run_p.add_argument("out", help="output JSON file")
+    run_p.add_argument("modules", nargs="+", help="reference Vita ELFs")
+    run_p.add_argument("--db", required=True, help="NID database YAML")
+    run_p.add_argument("--headers", default=None, help="vitasdk header file")
+    run_p.set_defaults(func=cmd_run)
+
+    cmp_p = sub.add_parser("compare", help="diff two recorded runs")
+    cmp_p.add_argument("before")
+    cmp_p.add_argument("after")
+    cmp_p.set_defaults(func=cmd_compare)
+
+    args = parser.parse_args(argv)
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
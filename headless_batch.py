@@ -0,0 +1,182 @@
+"""
+Headless batch analysis over a whole firmware dump.
+
+Usage:
+    python3 headless_batch.py <module_dir> --db merged-vita-nid-db.yml \
+        --headers vita_headers.hpp [-o <outdir>] [-j <workers>]
+
+Scans <module_dir> recursively for (decrypted) Vita ELFs, fans them out across
+a pool of worker processes, and runs the full sweep + VitaElf.load_vita_symbols
+pipeline on each through the headless Binary Ninja API, writing a .bndb per
+module. The NID database is compiled once up front (see nid_db_compiler); every
+worker mmaps the same compiled file, so the index is shared through the page
+cache instead of being parsed per process.
+
+Requires a Binary Ninja license with headless API access.
+"""
+import argparse
+import importlib
+import multiprocessing
+import os
+import sys
+
+#The plugin uses package-relative imports, so pull it in as a package by its
+#on-disk folder name, wherever the user checked it out.
+_plugin_dir = os.path.dirname(os.path.abspath(__file__))
+
+
+def _import_loader():
+    sys.path.insert(0, os.path.dirname(_plugin_dir))
+    return importlib.import_module(f"{os.path.basename(_plugin_dir)}.vita_loader")
+
+
+#worker process globals, set once by _init_worker
+_worker_cfg = None
+
+
+def _init_worker(db_path, header_path, out_dir, export_index=None):
+    global _worker_cfg
+    _worker_cfg = (db_path, header_path, out_dir, export_index)
+
+
+class _RawFile:
+    """
+    Minimal stand-in for a raw BinaryView backed by a plain file, enough for
+    VitaElf's parse/decode paths (read + len). Lets the workspace export scan
+    run without spinning up BN analysis per module.
+    """
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+
+    def read(self, offset, length):
+        return self.data[offset:offset + length]
+
+    def __len__(self):
+        return len(self.data)
+
+
+class _RawView:
+    def __init__(self, path):
+        self.parent_view = _RawFile(path)
+
+    def read(self, addr, length):
+        """
+        bv.read fallback for addresses va_to_offset can't map. A raw file has
+        no VA space to serve those from, so return empty: callers truncate and
+        the module still contributes its decodable exports instead of the whole
+        scan failing on an AttributeError.
+        """
+        return b""
+
+
+def build_workspace_export_index(modules, db_path):
+    """
+    Workspace phase 1: decode and resolve every module's export tables (raw
+    file parse only, no analysis) into one shared
+    (library_nid, nid) -> (name, module, addr) index. Phase 2 workers consult
+    it before the NID DB, so imports from bundled .suprx libs get the names
+    their actual exporters resolved.
+    """
+    vita_loader = _import_loader()
+    index = {}
+    for path in modules:
+        try:
+            vita = vita_loader.VitaElf(_RawView(path), nid_db_path=db_path)
+            vita.parse_elf()
+            vita.parse_sce_module_info()
+            vita.load_nid_database()
+            for key, value in vita.collect_exports().items():
+                index.setdefault(key, value)
+        except Exception as e:
+            print(f"{path}: export scan failed: {e}")
+    print(f"workspace export index: {len(index)} symbols from {len(modules)} modules")
+    return index
+
+
+def find_vita_elfs(root):
+    """
+    Walk root and yield paths that look like ELFs. Encrypted .self files won't
+    have the raw magic and are skipped; decrypt the dump first.
+    """
+    for dirpath, _, filenames in os.walk(root):
+        for filename in filenames:
+            path = os.path.join(dirpath, filename)
+            try:
+                with open(path, "rb") as f:
+                    if f.read(4) == b"\x7fELF":
+                        yield path
+            except OSError:
+                continue
+
+
+def analyze_module(path):
+    """
+    Full pipeline for one module: load, sweep until stable, inject symbols,
+    save .bndb. Returns (path, status_string) for the parent's summary.
+    """
+    db_path, header_path, out_dir, export_index = _worker_cfg
+    try:
+        import binaryninja
+        vita_loader = _import_loader()
+
+        bv = binaryninja.load(path)
+        if bv is None:
+            return (path, "failed to load BinaryView")
+        try:
+            vita = vita_loader.VitaElf(bv, nid_db_path=db_path, header_path=header_path)
+            vita.shared_export_index = export_index
+            vita_loader.run_linear_sweeps(bv, vita)
+            vita.load_vita_symbols()
+            out_path = os.path.join(out_dir, os.path.basename(path) + ".bndb")
+            bv.create_database(out_path)
+            return (path, f"ok -> {out_path}")
+        finally:
+            bv.file.close()
+    except Exception as e:
+        return (path, f"error: {e}")
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Batch-analyze a directory of Vita ELF modules headlessly")
+    parser.add_argument("module_dir", help="directory containing decrypted Vita ELFs")
+    parser.add_argument("--db", required=True, help="NID database YAML (compiled form is built/reused automatically)")
+    parser.add_argument("--headers", default=None, help="vitasdk header file for function types")
+    parser.add_argument("-o", "--out-dir", default=None, help="where to write .bndb files (default: module_dir)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="worker processes (default: all cores)")
+    parser.add_argument("--workspace", action="store_true",
+                        help="resolve imports against the other modules' exports before the NID DB")
+    args = parser.parse_args(argv)
+
+    out_dir = args.out_dir or args.module_dir
+    os.makedirs(out_dir, exist_ok=True)
+
+    #Compile the DB once in the parent so workers never race the rebuild and
+    #all of them mmap the same file. A sharded DB directory has no single
+    #compiled form; workers stream-parse the shard files themselves.
+    if not os.path.isdir(args.db):
+        sys.path.insert(0, os.path.dirname(_plugin_dir))
+        nid_db_compiler = importlib.import_module(f"{os.path.basename(_plugin_dir)}.nid_db_compiler")
+        nid_db_compiler.load_compiled_db(args.db).close()
+
+    modules = sorted(find_vita_elfs(args.module_dir))
+    if not modules:
+        print(f"no ELF modules found under {args.module_dir}")
+        return 1
+    print(f"analyzing {len(modules)} modules with {args.jobs} workers")
+
+    export_index = build_workspace_export_index(modules, args.db) if args.workspace else None
+
+    failures = 0
+    with multiprocessing.Pool(args.jobs, initializer=_init_worker,
+                              initargs=(args.db, args.headers, out_dir, export_index)) as pool:
+        for path, status in pool.imap_unordered(analyze_module, modules):
+            print(f"{path}: {status}")
+            if not status.startswith("ok"):
+                failures += 1
+    print(f"done: {len(modules) - failures}/{len(modules)} succeeded")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
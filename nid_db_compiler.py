@@ -0,0 +1,211 @@
+"""
+Offline compiler for the YAML NID database.
+
+Converts merged-vita-nid-db.yml into a compact binary format the plugin can
+mmap and binary-search directly, instead of paying a full yaml.safe_load per
+binary. The YAML stays the source of truth; the compiled file records the
+source file's size/mtime so a stale compile is detected and rebuilt.
+
+Can also be run standalone: python3 nid_db_compiler.py merged-vita-nid-db.yml
+
+Layout (little endian):
+    0x00  magic      "VNDB"
+    0x04  version    u32
+    0x08  src_size   u64   stat of the source YAML at compile time
+    0x10  src_mtime  u64   st_mtime_ns of the source YAML
+    0x18  nfunc      u32
+    0x1C  nvar       u32
+    0x20  library bloom filter: BLOOM_BITS bits over every library_nid present,
+          so lookups against libraries absent from the DB (common on homebrew)
+          short-circuit without touching the record arrays
+          function records: nfunc * (libnid u32, nid u32, name_off u32), sorted by (libnid, nid)
+          variable records: nvar  * (libnid u32, nid u32, name_off u32), sorted by (libnid, nid)
+          string table: NUL-terminated names, name_off relative to table start
+"""
+import mmap
+import os
+import struct
+import sys
+
+import yaml
+
+DB_MAGIC = b"VNDB"
+DB_VERSION = 2
+DB_HEADER = struct.Struct("<4sIQQII")
+DB_RECORD = struct.Struct("<III")
+BLOOM_BITS = 1 << 16  #8 KiB bitmap, a few hundred libraries -> negligible false positives
+
+
+def _bloom_positions(library_nid):
+    #two cheap bit positions; library NIDs are already well-mixed 32-bit hashes
+    h1 = library_nid & 0xFFFF
+    h2 = (library_nid >> 16) & 0xFFFF
+    return h1, (h1 + h2 + 1) & (BLOOM_BITS - 1)
+
+
+def compiled_db_path(yaml_path):
+    """
+    Compiled file lives next to the source YAML.
+    """
+    return yaml_path + ".vnidb"
+
+
+def compile_nid_database(yaml_path, out_path=None):
+    """
+    Parse the YAML DB and write the compiled binary form. Returns the output path.
+    """
+    if out_path is None:
+        out_path = compiled_db_path(yaml_path)
+
+    src_stat = os.stat(yaml_path)
+    with open(yaml_path, "r") as f:
+        db = yaml.safe_load(f)
+
+    func_records = []
+    var_records = []
+    strtab = bytearray()
+    name_offsets = {}
+
+    def intern(name):
+        off = name_offsets.get(name)
+        if off is None:
+            off = len(strtab)
+            name_offsets[name] = off
+            strtab.extend(name.encode("ascii", errors="ignore") + b"\x00")
+        return off
+
+    for module_name, module in (db or {}).get("modules", {}).items():
+        for lib_name, lib in module.get("libraries", {}).items():
+            library_nid = lib.get("nid")
+            if library_nid is None:
+                continue
+            for func_name, nid in lib.get("functions", {}).items():
+                func_records.append((library_nid, nid, intern(func_name)))
+            for var_name, nid in lib.get("variables", {}).items():
+                var_records.append((library_nid, nid, intern(var_name)))
+
+    func_records.sort()
+    var_records.sort()
+
+    bloom = bytearray(BLOOM_BITS // 8)
+    for library_nid, _, _ in func_records:
+        for pos in _bloom_positions(library_nid):
+            bloom[pos >> 3] |= 1 << (pos & 7)
+    for library_nid, _, _ in var_records:
+        for pos in _bloom_positions(library_nid):
+            bloom[pos >> 3] |= 1 << (pos & 7)
+
+    #write to a temp file and rename so a crashed compile never leaves a truncated DB
+    tmp_path = out_path + ".tmp"
+    with open(tmp_path, "wb") as f:
+        f.write(DB_HEADER.pack(DB_MAGIC, DB_VERSION, src_stat.st_size,
+                               src_stat.st_mtime_ns, len(func_records), len(var_records)))
+        f.write(bloom)
+        for rec in func_records:
+            f.write(DB_RECORD.pack(*rec))
+        for rec in var_records:
+            f.write(DB_RECORD.pack(*rec))
+        f.write(strtab)
+    os.replace(tmp_path, out_path)
+    return out_path
+
+
+class CompiledNidDatabase:
+    """
+    Memory-mapped view over a compiled NID DB. Lookups are binary searches over
+    the fixed-size sorted record arrays, no Python dicts materialized.
+    """
+    def __init__(self, path):
+        self._f = open(path, "rb")
+        self._mm = mmap.mmap(self._f.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, version, self.src_size, self.src_mtime,
+         self.nfunc, self.nvar) = DB_HEADER.unpack_from(self._mm, 0)
+        if magic != DB_MAGIC or version != DB_VERSION:
+            self.close()
+            raise Exception(f"Not a compiled NID DB (or wrong version): {path}")
+        self._bloom_base = DB_HEADER.size
+        self._func_base = self._bloom_base + BLOOM_BITS // 8
+        self._var_base = self._func_base + self.nfunc * DB_RECORD.size
+        self._strtab_base = self._var_base + self.nvar * DB_RECORD.size
+
+    def close(self):
+        self._mm.close()
+        self._f.close()
+
+    def is_fresh(self, yaml_path):
+        """
+        True if the source YAML hasn't changed since this file was compiled.
+        """
+        try:
+            src_stat = os.stat(yaml_path)
+        except OSError:
+            return False
+        return (src_stat.st_size == self.src_size
+                and src_stat.st_mtime_ns == self.src_mtime)
+
+    def may_contain_library(self, library_nid):
+        """
+        Bloom-filter check over library NIDs. False means the library is
+        definitely absent, so per-NID lookups can skip the binary search.
+        """
+        for pos in _bloom_positions(library_nid):
+            if not (self._mm[self._bloom_base + (pos >> 3)] >> (pos & 7)) & 1:
+                return False
+        return True
+
+    def _name_at(self, off):
+        start = self._strtab_base + off
+        end = self._mm.find(b"\x00", start)
+        return self._mm[start:end].decode("ascii", errors="ignore")
+
+    def _search(self, base, count, library_nid, nid):
+        #manual binary search over the packed records, avoids building any index
+        lo, hi = 0, count
+        key = (library_nid, nid)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            rec_libnid, rec_nid, name_off = DB_RECORD.unpack_from(self._mm, base + mid * DB_RECORD.size)
+            if (rec_libnid, rec_nid) < key:
+                lo = mid + 1
+            elif (rec_libnid, rec_nid) > key:
+                hi = mid
+            else:
+                return self._name_at(name_off)
+        return None
+
+    def lookup_function(self, library_nid, function_nid):
+        if not self.may_contain_library(library_nid):
+            return None
+        return self._search(self._func_base, self.nfunc, library_nid, function_nid)
+
+    def lookup_variable(self, library_nid, variable_nid):
+        if not self.may_contain_library(library_nid):
+            return None
+        return self._search(self._var_base, self.nvar, library_nid, variable_nid)
+
+
+def load_compiled_db(yaml_path):
+    """
+    Return a fresh CompiledNidDatabase for the given YAML, compiling/rebuilding
+    it if missing or stale. Raises on compile failure.
+    """
+    out_path = compiled_db_path(yaml_path)
+    if os.path.exists(out_path):
+        try:
+            db = CompiledNidDatabase(out_path)
+            if db.is_fresh(yaml_path):
+                return db
+            db.close()
+        except Exception:
+            #old format version (or corrupt file) -> recompile below
+            pass
+    compile_nid_database(yaml_path, out_path)
+    return CompiledNidDatabase(out_path)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(f"usage: {sys.argv[0]} <nid-db.yml> [out.vnidb]")
+        sys.exit(1)
+    out = compile_nid_database(sys.argv[1], sys.argv[2] if len(sys.argv) > 2 else None)
+    print(f"wrote {out}")
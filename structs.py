@@ -26,108 +26,107 @@ def make_bn_struct(fmt, var_names):
     return struct
 
 
-
-
-#Common datatypes:
-def create_struct(bv: BinaryView, bn_type: str, addr: int):
-    if bn_type == "SceLibEnt_prx2arm":
-    # Add structs to bn datatypes
-        struct_fmt = "B B H H H H H B B B B I I I I"
-        struct_vars = [
+#Common datatypes. One (fmt, member names) definition per type; the BN Type is
+#built once on first use and cached in _struct_types, instead of reconstructing
+#the StructureBuilder on every create_struct call (once per import library).
+STRUCT_DEFS = {
+    "SceLibEnt_prx2arm": (
+        "B B H H H H H B B B B I I I I",
+        [
             "structsize", "reserved1", "version", "attribute", "nfunc",
             "nvar", "ntlsvar", "hashinfo", "hashinfotls", "reserved2",
             "nidaltsets", "libname_nid", "libname", "nidtable", "addtable"
-        ]
-        scelibent_dt = make_bn_struct(struct_fmt, struct_vars)
-        bv.define_user_type("SceLibEnt_prx2arm", Type.structure_type(scelibent_dt))
-
-        #Remove any mis-interpreted instructions(functions) at data_addr
-        try:
-            rem_func = bv.get_functions_containing(addr)
-            bv.remove_function(rem_func[0])
-        except:
-            pass
-        scelibent_type = bv.get_type_by_name("SceLibEnt_prx2arm")
-        bv.define_data_var(addr=addr,var_type=scelibent_type)
-
-    elif bn_type == "SceLibStub_prx2arm":
-        struct_fmt = "B B H H H H H 4s I I I I I I I I I"
-        struct_vars = [
+        ],
+    ),
+    "SceLibStub_prx2arm": (
+        "B B H H H H H 4s I I I I I I I I I",
+        [
             "structsize", "reserved1", "version", "attribute", "nfunc",
             "nvar", "ntlsvar", "reserved2", "libname_nid", "libname",
             "sce_sdk_version", "func_nidtable", "func_table", "var_nidtable",
             "var_table", "tls_nidtable", "tls_table"
-        ]
-        scelibstub_dt = make_bn_struct(struct_fmt, struct_vars)
-        bv.define_user_type("SceLibStub_prx2arm", Type.structure_type(scelibstub_dt))
-
-        #Remove any mis-interpreted instructions(functions) at data_addr
-        try:
-            rem_func = bv.get_functions_containing(addr)
-            bv.remove_function(rem_func[0])
-        except:
-            pass
-        scelibstub_type = bv.get_type_by_name("SceLibStub_prx2arm")
-        bv.define_data_var(addr=addr,var_type=scelibstub_type)
-
-    elif bn_type == "SceLibStub_prx2arm_new":
-        struct_fmt = "B B H H H H H I I I I I I"
-        struct_vars = [
+        ],
+    ),
+    "SceLibStub_prx2arm_new": (
+        "B B H H H H H I I I I I I",
+        [
             "structsize", "reserved1", "version", "attribute", "nfunc",
             "nvar", "ntlsvar", "libname_nid", "libname", "func_nidtable",
             "func_table", "var_nidtable", "var_table"
-        ]
-        scelibstub_dt = make_bn_struct(struct_fmt, struct_vars)
-        bv.define_user_type("SceLibStub_prx2arm_new", Type.structure_type(scelibstub_dt))
-
-        #Remove any mis-interpreted instructions(functions) at data_addr
-        try:
-            rem_func = bv.get_functions_containing(addr)
-            bv.remove_function(rem_func[0])
-        except:
-            pass
-        scelibstub_type = bv.get_type_by_name("SceLibStub_prx2arm_new")
-        bv.define_data_var(addr=addr,var_type=scelibstub_type)
-
-    elif bn_type == "SceModuleInfo_prx2arm":
-        struct_fmt = "H 2s 26s B B I I I I I I I I I I I I I I I"
-        struct_vars = [
+        ],
+    ),
+    "SceModuleInfo_prx2arm": (
+        "H 2s 26s B B I I I I I I I I I I I I I I I",
+        [
             "modattribute", "modversion", "modname", "terminal", "infoversion",
             "resreve", "ent_top", "ent_end", "stub_top", "stub_end",
             "dbg_fingerprint", "tls_top", "tls_filesz", "tls_memsz",
             "start_entry", "stop_entry", "arm_exidx_top", "arm_exidx_end",
             "arm_extab_top", "arm_extab_end"
-        ]
-        scemodinfo_dt = make_bn_struct(struct_fmt, struct_vars)
-        bv.define_user_type("SceModuleInfo_prx2arm", Type.structure_type(scemodinfo_dt))
-
-        #Remove any mis-interpreted instructions(functions) at data_addr
-        try:
-            rem_func = bv.get_functions_containing(addr)
-            bv.remove_function(rem_func[0])
-        except:
-            pass
-        scemodinfo_type = bv.get_type_by_name("SceModuleInfo_prx2arm")
-        bv.define_data_var(addr=addr,var_type=scemodinfo_type)
-
+        ],
+    ),
     #This one is a bit tricky as size varies between 0x20 on FW 0.895, 0x2C on FW 0.931.010, 0x30 on FW 0.945, 0x34 on FW 3.60. We take on the 0x30 default for the time being, tiny errors don't really matter here but TODO: Get size first.
-    elif bn_type == "SceProcessParam":
-        struct_fmt = "I 4s I I B* I I I B* I I B*"
-        struct_vars = [
+    "SceProcessParam": (
+        "I 4s I I B* I I I B* I I B*",
+        [
             "size", "magic", "version", "sdk_version", "sceUserMainThreadName",
             "sceUserMainThreadPriority", "sceUserMainThreadStackSize", "sceUserMainThreadAttribute",
             "sceProcessName", "sce_process_preload_disabled", "sceUserMainThreadCpuAffinityMask",
             "sce_libcparam"#, "unk_0x30"
-        ]
-        sceprocparam_dt = make_bn_struct(struct_fmt, struct_vars)
-        bv.define_user_type("SceProcessParam", Type.structure_type(sceprocparam_dt))
-
-        #Remove any mis-interpreted instructions(functions) at data_addr
-        try:
-            rem_func = bv.get_functions_containing(addr)
-            bv.remove_function(rem_func[0])
-        except:
-            pass
-        sceprocparam_type = bv.get_type_by_name("SceProcessParam")
-        bv.define_data_var(addr=addr,var_type=sceprocparam_type)
+        ],
+    ),
+}
+
+#name -> built BN Type, filled lazily so the registry works before BN core init
+_struct_types = {}
+
+
+def get_struct_type(bn_type: str):
+    """
+    Return the cached BN Type for one of the STRUCT_DEFS names, building it on
+    first request.
+    """
+    struct_type = _struct_types.get(bn_type)
+    if struct_type is None and bn_type in STRUCT_DEFS:
+        fmt, var_names = STRUCT_DEFS[bn_type]
+        struct_type = Type.structure_type(make_bn_struct(fmt, var_names))
+        _struct_types[bn_type] = struct_type
+    return struct_type
+
+
+def remove_misidentified_function(bv: BinaryView, addr: int):
+    """
+    Remove any mis-interpreted instructions(functions) at a data addr.
+    """
+    try:
+        rem_func = bv.get_functions_containing(addr)
+        bv.remove_function(rem_func[0])
+    except:
+        pass
+
+
+def ensure_struct_type(bv: BinaryView, bn_type: str):
+    """
+    Make sure bn_type is defined in the BinaryView (at most once) and return
+    the view's Type for it, or None for names not in STRUCT_DEFS. Callers that
+    batch their data-var definitions use this instead of create_struct.
+    """
+    struct_type = get_struct_type(bn_type)
+    if struct_type is None:
+        return None
+    if bv.get_type_by_name(bn_type) is None:
+        bv.define_user_type(bn_type, struct_type)
+    return bv.get_type_by_name(bn_type)
+
 
+def create_struct(bv: BinaryView, bn_type: str, addr: int):
+    """
+    Define one of the known structs at addr. The type itself is defined in the
+    BinaryView at most once per session; repeat calls are just a data-var apply.
+    """
+    struct_type = ensure_struct_type(bv, bn_type)
+    if struct_type is None:
+        return
+
+    remove_misidentified_function(bv, addr)
+    bv.define_data_var(addr=addr, var_type=struct_type)
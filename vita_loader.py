@@ -6,23 +6,155 @@ from binaryninja import (
     Symbol,
     SymbolType,
     Type,
+    TypeClass,
+    Settings,
+    BackgroundTaskThread,
+    Architecture,
     get_open_filename_input,
     execute_on_main_thread
 )
-import threading
+from binaryninja.typelibrary import TypeLibrary
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import contextmanager
+import bisect
+import hashlib
+import json
+import os
 import struct
+import time
 import yaml
-from .structs import create_struct
+from .structs import ensure_struct_type
+from .nid_db_compiler import load_compiled_db
+
+#Process-wide caches so six tabs on modules from the same firmware share one
+#parsed NID DB and one parsed header instead of N copies. Keyed by
+#(path, mtime) so touching the source file invalidates the entry.
+_nid_db_cache = {}
+_header_cache = {}
+
+PLUGIN_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def _register_settings():
+    """
+    Register the plugin's settings so DB/header paths persist between sessions
+    and the modal prompts only ever appear on first use.
+    """
+    try:
+        settings = Settings()
+        settings.register_group("vitaLoader", "PSVita Loader")
+        settings.register_setting("vitaLoader.nidDatabasePath", json.dumps({
+            "title": "NID database path",
+            "description": "YAML NID database file (or sharded DB directory) used to resolve import/export names. Empty means prompt on first use.",
+            "type": "string",
+            "default": "",
+        }))
+        settings.register_setting("vitaLoader.headerPath", json.dumps({
+            "title": "vitasdk header path",
+            "description": "Header file used for function argument counts, names and types. Empty means prompt on first use.",
+            "type": "string",
+            "default": "",
+        }))
+        settings.register_setting("vitaLoader.autoLoadBundled", json.dumps({
+            "title": "Auto-load bundled DB and headers",
+            "description": "Use the merged-vita-nid-db.yml and vita_headers.hpp shipped with the plugin when no explicit paths are set, never prompting.",
+            "type": "boolean",
+            "default": False,
+        }))
+    except Exception:
+        #headless import without a settings registry, prompts/presets still work
+        pass
+
+
+_register_settings()
+
+
+def _configured_path(setting, bundled_name):
+    """
+    Resolve a path from settings, falling back to the bundled file when
+    auto-load is enabled. Returns None when unset (caller prompts).
+    """
+    try:
+        settings = Settings()
+        path = settings.get_string(f"vitaLoader.{setting}")
+        if path:
+            return path
+        if settings.get_bool("vitaLoader.autoLoadBundled"):
+            bundled = os.path.join(PLUGIN_DIR, bundled_name)
+            if os.path.exists(bundled):
+                return bundled
+    except Exception:
+        pass
+    return None
+
+
+def _remember_path(setting, path):
+    """
+    Persist a prompted path so the next load skips the dialog.
+    """
+    try:
+        Settings().set_string(f"vitaLoader.{setting}", path)
+    except Exception:
+        pass
+
+
+class HeaderTypes():
+    """
+    Minimal stand-in for the parse_types_from_source result when types come from
+    a cached type library instead: .types maps name->Type, .functions maps
+    name->function Type (which still exposes .parameters/.return_value).
+    """
+    def __init__(self, types, functions):
+        self.types = types
+        self.functions = functions
+
 
 class VitaElf():
-    def __init__(self, bv: BinaryView):
+    def __init__(self, bv: BinaryView, nid_db_path=None, header_path=None):
         """
         Initialize the Plugin, grabs default BinaryView.
+        nid_db_path/header_path preset the DB and header locations so headless
+        callers can skip the modal file prompts.
         """
         self.raw = bv.parent_view
         self.bv = bv
+        self.nid_db_path = nid_db_path
+        self.header_path = header_path
         self.nid_database = None
+        self.compiled_db = None
+        self.nid_func_index = {}
+        self.nid_var_index = {}
+        #library NIDs known to the dict indexes; None until a DB is loaded so
+        #lookups don't wrongly short-circuit before then
+        self.nid_lib_present = None
         self.struct_endianness = "<"  # Little endian for struct unpacking
+        #Symbols queued by process_imports/process_exports, applied in one batch
+        self.pending_functions = []
+        self.pending_data_vars = []
+        #(type name, addr) struct applications, recorded for the resolution cache
+        self.applied_structs = []
+        self.module_start_addr = None
+        #incremental mode diffs against already-defined symbols instead of
+        #redefining everything (see reinject_symbols)
+        self.incremental = False
+        #workspace mode: (library_nid, nid) -> (name, module, addr) built from
+        #sibling modules' exports, consulted before the NID DB
+        self.shared_export_index = None
+        #Header types already defined in this BinaryView (lazy definition)
+        self.defined_type_names = set()
+        self.header_type_map = {}
+        #name -> prebuilt function Type (filled by load_headers), plus the one
+        #shared fallback type instead of a fresh construction per symbol
+        self.func_type_map = {}
+        self.default_func_type = Type.function(Type.void(), [], variable_arguments=True)
+        #Per-phase wall times and hot-path counters, see log_report()
+        self.phase_times = {}
+        self.stats = {
+            "function_symbols": 0,
+            "data_symbols": 0,
+            "nid_hits": 0,
+            "nid_misses": 0,  #symbols that got the fallback LIBNAME_NID name
+        }
 
 
 
@@ -31,28 +163,118 @@ class VitaElf():
         Inject resolved function and variable symbols into the existing ARMv7 BinaryView.
 
         This first parses the raw ELF to find e_entry, uses that to locate the SceModuleInfo struct which contains start/end offsets for import/export stubs/entrys. These offsets are used to parse through and add import/export libraries including all functions(and variables) within using the NID DB as a lookup table. These library functions & variables are then loaded into the default ELF BinaryView. Finally, because BN picks up lots of instructions('functions') past the final import stub(stub_end) and Vita binaries (in all my tests) only contain in-line data past that point, these functions are removed from the BinaryView.
+
+        Runs both pipeline halves back to back (headless use); the UI path calls
+        resolve_symbols on the worker thread and commit_symbols on the main one.
+        """
+        if self.resolve_symbols():
+            self.commit_symbols()
+
+    def resolve_symbols(self):
+        """
+        Worker-thread half of the pipeline: all parsing, DB/header loading, and
+        NID resolution. Mutates no BinaryView state, only fills the pending
+        apply lists. Returns True when there is something to commit.
+        """
+        try:
+            with self.timed_phase("parse_elf"):
+                self.parse_elf()
+            with self.timed_phase("parse_sce_module_info"):
+                self.parse_sce_module_info()
+            with self.timed_phase("load_nid_database"):
+                self.load_nid_database()
+            with self.timed_phase("load_headers"):
+                self.load_headers()
+            #A binary seen before (same dbg_fingerprint, same DB/header) replays
+            #its cached symbol set instead of re-resolving everything.
+            if not self.load_resolution_cache():
+                with self.timed_phase("process_exports"):
+                    self.process_exports(self.bv)
+                with self.timed_phase("process_imports"):
+                    self.process_imports(self.bv)
+                self.save_resolution_cache()
+            return True
+        except Exception as e:
+            log_error(f"Error resolving symbols: {e}")
+            return False
+
+    def commit_symbols(self):
+        """
+        Main-thread half: one short batched BinaryView mutation applying
+        everything resolve_symbols queued, then cleanup and the load report.
         """
         try:
-            self.parse_elf()
-            self.parse_sce_module_info()
-            self.load_nid_database()
-            self.load_headers()
-            self.process_exports(self.bv)
-            self.process_imports(self.bv)
-            self.bv.add_entry_point(self.module_start_addr)
-            self.clean_data_segs()
+            with self.timed_phase("apply_symbols"):
+                self.apply_symbols(self.bv)
+            if self.module_start_addr is not None and not self.incremental:
+                self.bv.add_entry_point(self.module_start_addr)
+            if not self.incremental:
+                with self.timed_phase("clean_data_segs"):
+                    self.clean_data_segs()
             log_info("Symbols added successfully.")
+            self.log_report()
 
         except Exception as e:
             log_error(f"Error adding symbols: {e}")
 
+    @contextmanager
+    def timed_phase(self, phase):
+        """
+        Record wall time of one pipeline phase for the end-of-load report.
+        """
+        t0 = time.perf_counter()
+        try:
+            yield
+        finally:
+            self.phase_times[phase] = self.phase_times.get(phase, 0.0) + time.perf_counter() - t0
+
+    def log_report(self):
+        """
+        Emit the per-phase timing / counter report. When the
+        VITA_LOADER_REPORT_JSON env var names a file, the same report is appended
+        there as one JSON object per line for pipeline aggregation.
+        """
+        total = sum(self.phase_times.values())
+        symbols = self.stats["function_symbols"] + self.stats["data_symbols"]
+        lookups = self.stats["nid_hits"] + self.stats["nid_misses"]
+        apply_time = self.phase_times.get("apply_symbols", 0.0)
+        lines = [f"Load report for {getattr(self, 'modname', '?')} ({total:.2f}s total):"]
+        for phase, secs in self.phase_times.items():
+            lines.append(f"  {phase}: {secs * 1000:.1f} ms")
+        lines.append(f"  symbols: {self.stats['function_symbols']} functions, "
+                     f"{self.stats['data_symbols']} data"
+                     + (f" ({symbols / apply_time:.0f} symbols/s)" if apply_time > 0 and symbols else ""))
+        if lookups:
+            lines.append(f"  NID lookups: {self.stats['nid_hits']}/{lookups} hits, "
+                         f"{self.stats['nid_misses']} fallback-named")
+        log_info("\n".join(lines))
+
+        report_path = os.environ.get("VITA_LOADER_REPORT_JSON")
+        if report_path:
+            try:
+                report = {
+                    "module": getattr(self, "modname", None),
+                    "total_seconds": total,
+                    "phase_seconds": self.phase_times,
+                    "stats": self.stats,
+                }
+                with open(report_path, "a") as f:
+                    f.write(json.dumps(report) + "\n")
+            except Exception as e:
+                log_error(f"Failed to write JSON load report: {e}")
+
 
     def parse_elf(self):
         """
-        Parse the ELF and program headers
+        Parse the ELF and program headers.
+        The raw file is read once into a memoryview; every later raw-offset parse
+        (SceModuleInfo, stub tables, strings) decodes against that buffer with
+        struct.unpack_from instead of issuing many small BinaryView reads.
         """
-        header_data = self.raw.read(0, 0x40)
-        e_ident = header_data[:16]
+        self.elf_data = memoryview(self.raw.read(0, len(self.raw)))
+        if len(self.elf_data) < 0x40:
+            raise Exception("File too small to contain an ELF header")
+        e_ident = bytes(self.elf_data[:16])
         self.ei_class = e_ident[4]
         self.ei_data = e_ident[5]
 
@@ -68,8 +290,14 @@ class VitaElf():
         else:
             raise Exception("Unknown ELF data encoding")
 
+        #Precompile the stub/entry record codecs once, instead of re-deriving
+        #format strings on every iteration of the import/export walkers
+        self.libent_codec = struct.Struct(self.struct_endianness + "BBHHHHHBBBBIIII")
+        self.libstub_codec = struct.Struct(self.struct_endianness + "BBHHHHH4sIIIIIIIII")
+        self.libstub_new_codec = struct.Struct(self.struct_endianness + "BBHHHHHIIIIII")
+
         elf_header_struct = self.struct_endianness + "HHIIIIIHHHHHH"
-        elf_header = struct.unpack(elf_header_struct, header_data[16:52])
+        elf_header = struct.unpack_from(elf_header_struct, self.elf_data, 16)
 
         (
             self.e_type,
@@ -89,17 +317,28 @@ class VitaElf():
 
         #get the program headers.
         self.program_headers = []
+        ph_struct = self.struct_endianness + "IIIIIIII"
         for i in range(self.e_phnum):
             ph_offset = self.e_phoff + i * self.e_phentsize
-            ph_data = self.raw.read(ph_offset, self.e_phentsize)
-            if len(ph_data) < self.e_phentsize:
+            if ph_offset + self.e_phentsize > len(self.elf_data):
                 log_error(f"Incomplete program header {i} at offset 0x{ph_offset:X}")
                 continue
-            ph_struct = self.struct_endianness + "IIIIIIII"
-            ph = struct.unpack(ph_struct, ph_data)
+            ph = struct.unpack_from(ph_struct, self.elf_data, ph_offset)
             self.program_headers.append(ph)
         self.base_addr = self.program_headers[0][2]
 
+    def va_to_offset(self, addr):
+        """
+        Translate a virtual address to a file offset into elf_data using the
+        PT_LOAD program headers. Returns None if the address isn't file-backed.
+        """
+        PT_LOAD = 1
+        for ph in self.program_headers:
+            p_type, p_offset, p_vaddr, p_filesz = ph[0], ph[1], ph[2], ph[4]
+            if p_type == PT_LOAD and p_vaddr <= addr < p_vaddr + p_filesz:
+                return p_offset + (addr - p_vaddr)
+        return None
+
 
     def parse_sce_module_info(self):
         """
@@ -112,16 +351,11 @@ class VitaElf():
             return None
 
         module_info_size = 0x5C  #Including SceModuleInfo_common, can adjust later to pull SceModuleInfo_common first
-        module_info_data = self.raw.read(module_info_offset, module_info_size)
-        if len(module_info_data) < module_info_size:
+        #Validate SceModuleInfo fits in the mapped file
+        if module_info_offset + module_info_size > len(self.elf_data):
             log_error("Failed to read complete SceModuleInfo struct.")
             return None
 
-        #Validate SceModuleInfo
-        if len(module_info_data) < 0x5c:
-            log_error("Invalid SceModuleInfo struct.")
-            return None
-
         #unpacking SceModuleInfo, expanded for easier format character mapping
         module_info_struct = self.struct_endianness + (
             "H"    # unsigned short modattribute
@@ -145,7 +379,7 @@ class VitaElf():
             "I"    # Elf32_Addr arm_extab_top
             "I"    # Elf32_Addr arm_extab_end
         )
-        SceModuleInfo_unpacked = struct.unpack(module_info_struct, module_info_data)
+        SceModuleInfo_unpacked = struct.unpack_from(module_info_struct, self.elf_data, module_info_offset)
 
         (
             self.attributes,    # short modattribute
@@ -221,74 +455,420 @@ class VitaElf():
     def load_nid_database(self):
         """
         Promts the user for a YAML NID DB and loads the NID database from file.
+        Prefers the mmap'd compiled form (compiled/rebuilt next to the YAML by
+        nid_db_compiler), falling back to yaml.safe_load plus a flat
+        (library_nid, nid) -> name index so per-symbol lookups stay O(1).
         """
-        #prompt for yml file
-        nid_db_path = get_open_filename_input("Select NID database YAML file")
+        #preset path(headless) or settings beat the modal prompt
+        nid_db_path = self.nid_db_path or _configured_path("nidDatabasePath", "merged-vita-nid-db.yml")
+        prompted = nid_db_path is None
+        if prompted:
+            nid_db_path = get_open_filename_input("Select NID database YAML file")
         if not nid_db_path:
             raise Exception("NID database YAML file is required")
+        if isinstance(nid_db_path, bytes):
+            nid_db_path = nid_db_path.decode()
+        self.nid_db_path = nid_db_path
+        if prompted:
+            _remember_path("nidDatabasePath", nid_db_path)
+
+        #a directory means the sharded per-firmware layout; the loaded subset is
+        #binary-specific so it skips the process-wide cache
+        if os.path.isdir(nid_db_path):
+            self.load_sharded_nid_database(nid_db_path)
+            return
 
-        #load db in nid_database class var
+        #reuse the process-wide copy when another tab already loaded this DB
         try:
-            with open(nid_db_path, "r") as f:
-                self.nid_database = yaml.safe_load(f)
+            cache_key = (nid_db_path, os.path.getmtime(nid_db_path))
+        except OSError:
+            cache_key = None
+        cached = _nid_db_cache.get(cache_key) if cache_key else None
+        if cached is not None:
+            (self.compiled_db, self.nid_database, self.nid_func_index,
+             self.nid_var_index, self.nid_lib_present) = cached
+            return
+
+        #mmap the compiled DB, compiling it first if missing or stale
+        try:
+            self.compiled_db = load_compiled_db(nid_db_path)
         except Exception as e:
-            raise Exception(f"Failed to load NID database: {e}")
+            log_info(f"Compiled NID DB unavailable ({e}), falling back to YAML parse")
+            #stream only the libraries this binary references; the partial index
+            #is binary-specific so it deliberately stays out of the shared cache
+            try:
+                self.stream_load_nid_database(nid_db_path, self.collect_library_nids())
+                return
+            except Exception as e:
+                log_info(f"Streaming YAML load failed ({e}), doing a full parse")
+            #load db in nid_database class var
+            try:
+                with open(nid_db_path, "r") as f:
+                    self.nid_database = yaml.safe_load(f)
+            except Exception as e:
+                raise Exception(f"Failed to load NID database: {e}")
+            self.build_nid_index()
+
+        if cache_key:
+            _nid_db_cache[cache_key] = (self.compiled_db, self.nid_database,
+                                        self.nid_func_index, self.nid_var_index,
+                                        self.nid_lib_present)
+
+    def build_nid_index(self):
+        """
+        Flatten the nested modules->libraries->functions/variables DB into two
+        dicts keyed by (library_nid, nid). Built once per load, every lookup after
+        this is a single dict hit.
+        """
+        self.nid_func_index = {}
+        self.nid_var_index = {}
+        self.nid_lib_present = set()
+        if not self.nid_database or "modules" not in self.nid_database:
+            return
+        for module_name, module in self.nid_database["modules"].items():
+            if "libraries" not in module:
+                continue
+            for lib_name, lib in module["libraries"].items():
+                library_nid = lib.get("nid")
+                if library_nid is None:
+                    continue
+                self.nid_lib_present.add(library_nid)
+                for func_name, nid in lib.get("functions", {}).items():
+                    self.nid_func_index[(library_nid, nid)] = func_name
+                for var_name, nid in lib.get("variables", {}).items():
+                    self.nid_var_index[(library_nid, nid)] = var_name
+
+    def collect_sdk_version(self):
+        """
+        First non-zero sce_sdk_version from the import stubs. Only the 0x34
+        _scelibstub_prx2arm layout carries it (at offset 0x18); returns None if
+        the binary has none.
+        """
+        ph_offset = self.program_headers[0][1]
+        offset = self.import_top + ph_offset
+        end = self.import_end + ph_offset
+        while offset + 2 <= min(end, len(self.elf_data)):
+            size = self.elf_data[offset] | (self.elf_data[offset + 1] << 8)
+            if size not in (0x34, 0x24) or size == 0:
+                break
+            if size == 0x34 and offset + 0x1C <= len(self.elf_data):
+                version = struct.unpack_from(f"{self.struct_endianness}I", self.elf_data, offset + 0x18)[0]
+                if version:
+                    return version
+            offset += size
+        return None
+
+    def select_firmware_shard(self, db_dir):
+        """
+        Pick the firmware subdirectory matching this binary's sce_sdk_version
+        (0x03600011 -> "360", vitasdk's db layout), falling back to the newest
+        shard present.
+        """
+        shards = sorted(entry for entry in os.listdir(db_dir)
+                        if os.path.isdir(os.path.join(db_dir, entry)))
+        if not shards:
+            raise Exception(f"No firmware shards found under {db_dir}")
+        sdk_version = self.collect_sdk_version()
+        if sdk_version:
+            fw = f"{(sdk_version >> 24) & 0xFF:x}{(sdk_version >> 16) & 0xFF:02x}"
+            if fw in shards:
+                return fw
+            log_info(f"No shard for firmware {fw}, using {shards[-1]}")
+        return shards[-1]
+
+    def load_sharded_nid_database(self, db_dir):
+        """
+        Load from a DB sharded as <dir>/<firmware>/<module>.yml. Selects the
+        shard from the binary's SDK version, then stream-parses only the module
+        files that mention a referenced library NID (cheap text pre-filter on
+        the hex NID strings), keeping resident memory to just those modules.
+        """
+        wanted_nids = self.collect_library_nids()
+        shard = self.select_firmware_shard(db_dir)
+        shard_dir = os.path.join(db_dir, shard)
+        #vitasdk writes NIDs as uppercase 0x hex; check both cases to be safe
+        markers = [f"0x{nid:08X}" for nid in wanted_nids] + [f"0x{nid:08x}" for nid in wanted_nids]
+
+        loaded = 0
+        for filename in sorted(os.listdir(shard_dir)):
+            if not filename.endswith((".yml", ".yaml")):
+                continue
+            path = os.path.join(shard_dir, filename)
+            try:
+                with open(path, "r") as f:
+                    text = f.read()
+            except OSError:
+                continue
+            if not any(marker in text for marker in markers):
+                continue
+            self.stream_load_nid_database(path, wanted_nids)
+            loaded += 1
+        log_info(f"Sharded NID DB: loaded {loaded} module files from {shard_dir}")
+
+    def collect_library_nids(self):
+        """
+        Cheap pre-scan over the import and export stub tables collecting every
+        library_nid this binary references. Only the size and libname_nid fields
+        are decoded; used to filter the streaming YAML load below.
+        """
+        nids = set()
+        ph_offset = self.program_headers[0][1]
+
+        #imports: libname_nid at 0x10 (_scelibstub_prx2arm) or 0xC (the _new form)
+        offset = self.import_top + ph_offset
+        end = self.import_end + ph_offset
+        while offset + 2 <= min(end, len(self.elf_data)):
+            size = self.elf_data[offset] | (self.elf_data[offset + 1] << 8)
+            nid_offset = 0x10 if size == 0x34 else 0xC if size == 0x24 else None
+            if nid_offset is None or size == 0:
+                break
+            if offset + nid_offset + 4 <= len(self.elf_data):
+                nids.add(struct.unpack_from(f"{self.struct_endianness}I", self.elf_data, offset + nid_offset)[0])
+            offset += size
+
+        #exports: libname_nid fixed at 0x10 in _scelibent_prx2arm
+        offset = self.export_top + ph_offset
+        end = self.export_end + ph_offset
+        while offset + 2 <= min(end, len(self.elf_data)):
+            size = self.elf_data[offset] | (self.elf_data[offset + 1] << 8)
+            if size < 0x14:
+                break
+            if offset + 0x14 <= len(self.elf_data):
+                nids.add(struct.unpack_from(f"{self.struct_endianness}I", self.elf_data, offset + 0x10)[0])
+            offset += size
+
+        return nids
+
+    def stream_load_nid_database(self, nid_db_path, wanted_nids):
+        """
+        Event-level YAML walk (C-accelerated loader when available) that only
+        materializes libraries whose nid the binary actually references,
+        straight into the flat lookup indexes. The rest of the DB is never
+        built as Python objects, keeping resident memory to the ~30 libraries a
+        typical game touches instead of the whole database.
+        """
+        loader = getattr(yaml, "CSafeLoader", yaml.SafeLoader)
+
+        def parse_scalar(value):
+            try:
+                return int(value, 0)
+            except (TypeError, ValueError):
+                return value
+
+        path = []       #mapping key path, one entry per open mapping
+        key_stack = []  #pending key per mapping level (None = expecting a key)
+        cur_lib = None  #library currently being collected, or None
+        #accumulate across calls: the sharded loader streams one file per module,
+        #resetting here would leave only the last file's libraries in the set
+        if self.nid_lib_present is None:
+            self.nid_lib_present = set()
+
+        with open(nid_db_path, "r") as f:
+            for event in yaml.parse(f, Loader=loader):
+                if isinstance(event, yaml.ScalarEvent):
+                    if not key_stack:
+                        continue
+                    if key_stack[-1] is None:
+                        key_stack[-1] = event.value
+                        continue
+                    key = key_stack[-1]
+                    key_stack[-1] = None
+                    if cur_lib is None:
+                        continue
+                    if len(path) == 5 and key == "nid":
+                        cur_lib["nid"] = parse_scalar(event.value)
+                    elif len(path) == 6 and path[5] == "functions":
+                        cur_lib["functions"][key] = parse_scalar(event.value)
+                    elif len(path) == 6 and path[5] == "variables":
+                        cur_lib["variables"][key] = parse_scalar(event.value)
+                elif isinstance(event, yaml.MappingStartEvent):
+                    parent_key = key_stack[-1] if key_stack else None
+                    if key_stack:
+                        key_stack[-1] = None
+                    path.append(parent_key)
+                    key_stack.append(None)
+                    if (cur_lib is None and len(path) == 5
+                            and path[1] == "modules" and path[3] == "libraries"):
+                        cur_lib = {"nid": None, "functions": {}, "variables": {}}
+                elif isinstance(event, yaml.MappingEndEvent):
+                    if (cur_lib is not None and len(path) == 5
+                            and path[1] == "modules" and path[3] == "libraries"):
+                        #library fully read, keep it only if the binary uses it
+                        if cur_lib["nid"] in wanted_nids:
+                            self.nid_lib_present.add(cur_lib["nid"])
+                            for func_name, nid in cur_lib["functions"].items():
+                                self.nid_func_index[(cur_lib["nid"], nid)] = func_name
+                            for var_name, nid in cur_lib["variables"].items():
+                                self.nid_var_index[(cur_lib["nid"], nid)] = var_name
+                        cur_lib = None
+                    path.pop()
+                    key_stack.pop()
+
+        log_info(f"Streamed NID DB: kept {len(self.nid_func_index)} functions, "
+                 f"{len(self.nid_var_index)} variables for {len(wanted_nids)} libraries")
 
     def load_headers(self):
         """
         Promts the user for a vitasdk header file.
         This is used to add vita datatypes & resolve functions argument count, names, types, and returns.
+        A prebuilt .bntl type library cached per header content hash is preferred;
+        parsing the 9k-line header source is only done once per header generation.
         """
-        header_path = get_open_filename_input("Select header file. RECOMMENDED for proper func arg count,type,names")
+        header_path = self.header_path or _configured_path("headerPath", "vita_headers.hpp")
+        prompted = header_path is None
+        if prompted:
+            header_path = get_open_filename_input("Select header file. RECOMMENDED for proper func arg count,type,names")
         if not header_path:
             log_info("No header file specified. Functions will default to void and argument count, name, and types will NOT be loaded.")
             self.sdk_hdr = 0
+            return
+        if isinstance(header_path, bytes):
+            header_path = header_path.decode()
+        self.header_path = header_path
+        if prompted:
+            _remember_path("headerPath", header_path)
+
+        #reuse the process-wide parse when another tab already loaded this header
+        try:
+            cache_key = (header_path, os.path.getmtime(header_path))
+        except OSError:
+            cache_key = None
+        cached = _header_cache.get(cache_key) if cache_key else None
+        if cached is not None:
+            self.sdk_hdr = cached
         else:
+            #Try the cached type library first, deserializing beats a full C parse
+            self.sdk_hdr = self.load_header_typelib(header_path)
+            if self.sdk_hdr is None:
+                try:
+                    with open(header_path, 'r') as f:
+                        header_content = f.read()
+                except:
+                    log_error("Failed to load header file")
+
+                #Store all types from vitasdk header for class-wide use.
+                self.sdk_hdr = self.bv.platform.parse_types_from_source(header_content)
+                self.save_header_typelib(header_path)
+            if cache_key:
+                _header_cache[cache_key] = self.sdk_hdr
+
+        #Don't push all few thousand vitasdk types into the BinaryView up front;
+        #define_referenced_types pulls in just the ones signatures actually use.
+        self.header_type_map = {str(name): tobj for name, tobj in self.sdk_hdr.types.items()}
+
+        #One-time pass building name -> ready-to-apply function Type, so
+        #define_function_symbol is a dict hit instead of two sdk_hdr probes
+        #plus a fresh Type.function construction per symbol.
+        self.func_type_map = {
+            str(name): Type.function(fobj.return_value, fobj.parameters, variable_arguments=False)
+            for name, fobj in self.sdk_hdr.functions.items()
+        }
+
+    def define_referenced_types(self, tobj):
+        """
+        Lazily define the header types transitively referenced by a type that is
+        about to be applied (a function signature, usually). Only these — not the
+        whole vitasdk type set — end up in the BinaryView and the .bndb.
+        """
+        stack = [tobj]
+        while stack:
+            t = stack.pop()
             try:
-                with open(header_path, 'r') as f:
-                    header_content = f.read()
-            except:
-                log_error("Failed to load header file")
-
-            #Store all types from vitasdk header for class-wide use.
-            self.sdk_hdr = self.bv.platform.parse_types_from_source(header_content)
-            #Add types while we are here to avoid another header check
+                if t.type_class == TypeClass.NamedTypeReferenceClass:
+                    name = str(t.named_type_reference.name)
+                    if name in self.defined_type_names:
+                        continue
+                    self.defined_type_names.add(name)
+                    referenced = self.header_type_map.get(name)
+                    if referenced is not None:
+                        self.bv.define_user_type(name, referenced)
+                        stack.append(referenced)
+                else:
+                    stack.extend(t.children)
+            except Exception:
+                continue
+
+    def header_typelib_path(self, header_path):
+        """
+        Content-hash-keyed .bntl path for a header, under ~/.cache/vita_loader.
+        Keying on the hash means every header generation (3.60, 3.65, custom
+        forks) gets its own cache entry, and switching between them in one
+        session never re-parses; editing a header simply produces a new key.
+        """
+        with open(header_path, "rb") as f:
+            digest = hashlib.sha256(f.read()).hexdigest()[:16]
+        cache_dir = os.path.join(os.path.expanduser("~"), ".cache", "vita_loader", "headers")
+        os.makedirs(cache_dir, exist_ok=True)
+        return os.path.join(cache_dir, f"{os.path.basename(header_path)}.{digest}.bntl")
+
+    def load_header_typelib(self, header_path):
+        """
+        Load the cached type library for this header's content hash, if one
+        exists. Returns a HeaderTypes mirroring parse_types_from_source
+        (.types/.functions) or None if the cache is missing.
+        """
+        try:
+            bntl_path = self.header_typelib_path(header_path)
+            if not os.path.exists(bntl_path):
+                return None
+            typelib = TypeLibrary.load_from_file(bntl_path)
+            if typelib is None:
+                return None
+            self.bv.add_type_library(typelib)
+            return HeaderTypes(dict(typelib.named_types), dict(typelib.named_objects))
+        except OSError:
+            return None
+        except Exception as e:
+            log_info(f"Cached type library unusable ({e}), reparsing header")
+            return None
+
+    def save_header_typelib(self, header_path):
+        """
+        Serialize the freshly parsed header types to the content-hash-keyed
+        .bntl so later loads of the same header skip the C parse entirely.
+        """
+        try:
+            bntl_path = self.header_typelib_path(header_path)
+            typelib = TypeLibrary.new(self.bv.arch, os.path.basename(header_path))
+            typelib.add_platform(self.bv.platform)
             for name, tobj in self.sdk_hdr.types.items():
-	            self.bv.define_user_type(name, tobj)
+                typelib.add_named_type(name, tobj)
+            for name, fobj in self.sdk_hdr.functions.items():
+                typelib.add_named_object(name, fobj)
+            typelib.finalize()
+            typelib.write_to_file(bntl_path)
+            log_info(f"Cached header type library at {bntl_path}")
+        except Exception as e:
+            log_info(f"Failed to cache header type library: {e}")
 
 
 
 
 
-    def process_exports(self, bv: BinaryView):
+    def decode_export_libraries(self):
         """
-        Process module exports, get library name, enumerate and lookup funcs/vars by NID, add functions/variable symbols into the default ELF BinaryView.
+        Decode the whole ent_top..ent_end region in one pass into typed export
+        library records: header fields via the precompiled codec, library name,
+        and the NID/entry tables read in bulk. No BinaryView mutation here —
+        application happens in process_exports against these records.
         """
-        log_info("Parsing exports")
+        records = []
         ph_offset = self.program_headers[0][1]
         exports_offset = self.export_top + ph_offset
         exports_end = self.export_end + ph_offset
-        if not exports_offset or not exports_end:
-            log_error("Export sections not defined in SceModuleInfo.")
-            return
-
 
         while exports_offset < exports_end:
             #Consider splitting out _scelibent_ppu_common(size: 0x10), could be useful to leave flexibility for potential future integration of scelibent_psp and other PRX1 variants.
-            export_size_data = self.raw.read(exports_offset, 2)
-            if len(export_size_data) < 2:
+            if exports_offset + 2 > len(self.elf_data):
                 log_error(f"Incomplete export size data at 0x{exports_offset:X}")
                 break
-            export_size = int.from_bytes(export_size_data, "little")
-            export_data = self.raw.read(exports_offset, export_size)
-            if len(export_data) < export_size:
+            export_size = self.elf_data[exports_offset] | (self.elf_data[exports_offset + 1] << 8)
+            if exports_offset + export_size > len(self.elf_data):
                 log_error(f"Incomplete export data at 0x{exports_offset:X}")
                 break
-            export_struct = self.struct_endianness + "BBHHHHHBBBBIIII"
-            if len(export_data) < struct.calcsize(export_struct):
+            if export_size < self.libent_codec.size:
                 log_error(f"Incomplete export structure at 0x{exports_offset:X}")
                 break
-            export_struct = struct.unpack(export_struct, export_data[:struct.calcsize(export_struct)])
             (
                 size,               #unsigned char structsize;
                 reserved1,          #unsigned char reserved1[1]; //a.k.a. 'auxattribute'
@@ -305,28 +885,80 @@ class VitaElf():
                 library_name_addr,  #Elf32_Addr libname;
                 nid_table_addr,     #Elf32_Addr nidtable;
                 entry_table_addr,   #Elf32_Addr addtable;
-            ) = export_struct
-
-            # Add structs to bn datatypes
-            abs_addr = self.base_addr + exports_offset - ph_offset
-            create_struct(self.bv, "SceLibEnt_prx2arm", abs_addr)
-
+            ) = self.libent_codec.unpack_from(self.elf_data, exports_offset)
 
             if attribute == 0x8000 and library_name_addr == 0:
                 library_name = "NONAME" #NONAME EXPORT,see: wiki.henkaku.xyz/vita/PRX#NONAME_exports
             else:
-                library_name = self.read_string_at(bv, library_name_addr)
-            #log_info(f"Exporting library: {library_name}\nExport struct: {export_struct}") #debug
-
-            for i in range(num_functions):
-                nid_addr = nid_table_addr + i * 4
-                entry_addr = entry_table_addr + i * 4
-                nid_data = bv.read(nid_addr, 4)
-                entry_data = bv.read(entry_addr, 4)
-                if len(nid_data) < 4 or len(entry_data) < 4:
-                    continue
-                function_nid = struct.unpack("<I", nid_data)[0]
-                function_addr = struct.unpack("<I", entry_data)[0]
+                library_name = self.read_string_at(self.bv, library_name_addr)
+            #log_info(f"Exporting library: {library_name}") #debug
+
+            #read both tables once, sized for funcs + vars, instead of 4 bytes at a time
+            total_entries = num_functions + num_vars
+            records.append({
+                "abs_addr": self.base_addr + exports_offset - ph_offset,
+                "library_nid": library_nid,
+                "library_name": library_name,
+                "num_functions": num_functions,
+                "num_vars": num_vars,
+                "nid_table": self.read_word_table(self.bv, nid_table_addr, total_entries),
+                "entry_table": self.read_word_table(self.bv, entry_table_addr, total_entries),
+            })
+            exports_offset += size
+
+        return records
+
+    def collect_exports(self):
+        """
+        Resolve this module's export tables into a
+        (library_nid, nid) -> (name, module name, export addr) index for the
+        workspace-level cross-module resolver. NONAME (module control) exports
+        are skipped since nothing imports them by NID. Needs parse_elf,
+        parse_sce_module_info, and load_nid_database to have run; no BinaryView
+        mutation.
+        """
+        index = {}
+        for record in self.decode_export_libraries():
+            if record["library_name"] == "NONAME":
+                continue
+            library_nid = record["library_nid"]
+            library_name = record["library_name"]
+            num_functions = record["num_functions"]
+            nid_table = record["nid_table"]
+            entry_table = record["entry_table"]
+            for i in range(min(len(nid_table), len(entry_table))):
+                nid = nid_table[i]
+                if i < num_functions:
+                    name = self.lookup_nid_function(library_nid, nid, library_name)
+                else:
+                    name = self.lookup_nid_variable(library_nid, nid, library_name)
+                index[(library_nid, nid)] = (name, self.modname, entry_table[i])
+        return index
+
+    def process_exports(self, bv: BinaryView):
+        """
+        Process module exports, get library name, enumerate and lookup funcs/vars by NID, add functions/variable symbols into the default ELF BinaryView.
+        Consumes the typed records produced by decode_export_libraries.
+        """
+        log_info("Parsing exports")
+        if not self.export_top or not self.export_end:
+            log_error("Export sections not defined in SceModuleInfo.")
+            return
+
+        for record in self.decode_export_libraries():
+            library_nid = record["library_nid"]
+            library_name = record["library_name"]
+            num_functions = record["num_functions"]
+            num_vars = record["num_vars"]
+            nid_table = record["nid_table"]
+            entry_table = record["entry_table"]
+
+            # Add structs to bn datatypes
+            self.add_struct("SceLibEnt_prx2arm", record["abs_addr"])
+
+            for i in range(min(num_functions, len(nid_table), len(entry_table))):
+                function_nid = nid_table[i]
+                function_addr = entry_table[i]
                 if library_name == "NONAME" and function_nid == 0x935CD196:
                     function_name = "module_start"
                     self.module_start_addr = function_addr
@@ -338,75 +970,64 @@ class VitaElf():
 
 
             for i in range(num_vars):
-                nid_addr = nid_table_addr + (num_functions + i) * 4
-                entry_addr = entry_table_addr + (num_functions + i) * 4
-                nid_data = bv.read(nid_addr, 4)
-                entry_data = bv.read(entry_addr, 4)
-                if len(nid_data) < 4 or len(entry_data) < 4:
-                    continue
-                variable_nid = struct.unpack("<I", nid_data)[0]
-                variable_addr = struct.unpack("<I", entry_data)[0]
+                idx = num_functions + i
+                if idx >= len(nid_table) or idx >= len(entry_table):
+                    break
+                variable_nid = nid_table[idx]
+                variable_addr = entry_table[idx]
                 # These two NONAME vars will always exist, TODO: Create lut(or add to nid.yml) as/if more are encountered in tests.
                 if library_name == "NONAME":
                     if variable_nid == 0x6C2224BA:
                         variable_name = "module_info"
-                        create_struct(self.bv, "SceModuleInfo_prx2arm", variable_addr)
+                        self.add_struct("SceModuleInfo_prx2arm", variable_addr)
                     elif variable_nid == 0x70FBA1E7:
                         variable_name = "module_proc_param"
-                        create_struct(self.bv, "SceProcessParam", variable_addr)
+                        self.add_struct("SceProcessParam", variable_addr)
                 else:
                     variable_name = self.lookup_nid_variable(library_nid, variable_nid, library_name)
                     # If NONAME, create_struct defines the data var, can later change this to return the struct and add optional var_type to add_data_symbol().
                     self.add_data_symbol(bv, variable_addr, variable_name)
                 #log_info(f"Exporting Variable: {variable_name} - Var addr: {hex(variable_addr)}") #debug
 
-            exports_offset += size
-
-    def process_imports(self, bv: BinaryView):
+    def decode_import_libraries(self):
         """
-        Process module imports, get library name, enumerate and lookup funcs/vars by NID, add functions/variable symbols into the default ELF BinaryView.
+        Decode the whole stub_top..stub_end region in one pass into typed import
+        library records, using the precompiled codecs for both scelibstub
+        layouts. Pure decoding — the structs/symbols are applied later from
+        these records.
         """
-        log_info("Parsing imports")
+        records = []
         ph_offset = self.program_headers[0][1]
         imports_offset = self.import_top + ph_offset
         imports_end = self.import_end + ph_offset
-        if not imports_offset or not imports_end:
-            log_error("Import sections not defined in SceModuleInfo.")
-            return
-
 
         while imports_offset < imports_end:
-            import_size_data = self.raw.read(imports_offset, 2)
-            if len(import_size_data) < 2:
+            if imports_offset + 2 > len(self.elf_data):
                 log_error(f"Incomplete import size data at 0x{imports_offset:X}")
                 break
-            import_size = int.from_bytes(import_size_data, "little")
+            import_size = self.elf_data[imports_offset] | (self.elf_data[imports_offset + 1] << 8)
 
             # TODO: Can potentially be expanded to OG PSP binaries as-well(_scelibstub_psp - size: 0x14 or 0x18).
             if import_size == 0x34:
-                # _scelibstub_prx2arm
-                import_struct = self.struct_endianness + "BBHHHHH4sIIIIIIIII"
-                import_struct_size = 0x34
+                # _scelibstub_prx2arm - see wiki.henkaku.xyz/vita/PRX#Imports
+                codec = self.libstub_codec
+                struct_name = "SceLibStub_prx2arm"
             elif import_size == 0x24:
                 # _scelibstub_prx2arm_new
-                import_struct = self.struct_endianness + "BBHHHHHIIIIII"
-                import_struct_size = 0x24
+                codec = self.libstub_new_codec
+                struct_name = "SceLibStub_prx2arm_new"
             else:
                 log_error(f"Unknown import size: {import_size} bytes at 0x{imports_offset:X}")
                 break
 
-
-            import_data = self.raw.read(imports_offset, import_size)
-            if len(import_data) < import_size:
+            if imports_offset + import_size > len(self.elf_data):
                 log_error(f"Incomplete import data at 0x{imports_offset:X}")
                 break
 
-            import_values = struct.unpack(import_struct, import_data[:import_struct_size])
+            import_values = codec.unpack_from(self.elf_data, imports_offset)
 
-            abs_addr = self.base_addr + imports_offset - ph_offset
             # Extract import fields based on format
             if import_size == 0x34:
-                # _scelibstub_prx2arm - see wiki.henkaku.xyz/vita/PRX#Imports
                 (
                     size,                   # unsigned char structsize
                     reserved1,              # unsigned char reserved1
@@ -426,10 +1047,7 @@ class VitaElf():
                     tls_nid_table_addr,     # Elf32_Addr tls_nidtable
                     tls_entry_table_addr,   # Elf32_Addr tls_table
                 ) = import_values
-                # Add structs to bn datatypes
-                create_struct(self.bv, "SceLibStub_prx2arm", abs_addr)
-            elif import_size == 0x24:
-                # _scelibstub_prx2arm_new
+            else:
                 (
                     size,                   # unsigned char structsize;
                     reserved1,              # unsigned char reserved1[1]
@@ -445,43 +1063,125 @@ class VitaElf():
                     var_nid_table_addr,     # Elf32_Addr var_nidtable
                     var_entry_table_addr,   # Elf32_Addr var_table
                 ) = import_values
-                # Add structs to bn datatypes
-                create_struct(self.bv, "SceLibStub_prx2arm_new", abs_addr)
-
+                sce_sdk_version = None
+
+            records.append({
+                "abs_addr": self.base_addr + imports_offset - ph_offset,
+                "struct_name": struct_name,
+                "library_nid": library_nid,
+                "library_name": self.read_string_at(self.bv, library_name_addr),
+                "sce_sdk_version": sce_sdk_version,
+                "func_nid_table": self.read_word_table(self.bv, func_nid_table_addr, num_functions),
+                "func_entry_table": self.read_word_table(self.bv, func_entry_table_addr, num_functions),
+                "var_nid_table": self.read_word_table(self.bv, var_nid_table_addr, num_vars),
+                "var_entry_table": self.read_word_table(self.bv, var_entry_table_addr, num_vars),
+            })
+            imports_offset += size
 
-            #get lib name
-            library_name = self.read_string_at(bv, library_name_addr)
-            #log_info(f"Importing Library: {library_name}\nImport unpacked: {import_values}") #debug
+        return records
 
-            # Process imported functions, lookup by nid, add symbol
-            for i in range(num_functions):
-                nid_addr = func_nid_table_addr + i * 4
-                entry_addr = func_entry_table_addr + i * 4
-                nid_data = bv.read(nid_addr, 4)
-                entry_data = bv.read(entry_addr, 4)
-                if len(nid_data) < 4 or len(entry_data) < 4:
-                    continue
-                function_nid = struct.unpack("<I", nid_data)[0]
-                function_stub_addr = struct.unpack("<I", entry_data)[0]
-                function_name = self.lookup_nid_function(library_nid, function_nid, library_name)
-                #log_info(f"Importing Function: {function_name}") #debug
-                self.add_function_symbol(bv, function_stub_addr, function_name)
+    def process_imports(self, bv: BinaryView):
+        """
+        Process module imports, get library name, enumerate and lookup funcs/vars by NID, add functions/variable symbols into the default ELF BinaryView.
+        Decoding happens in one pass up front (decode_import_libraries); this
+        just queues the structs and fans resolution out across libraries.
+        """
+        log_info("Parsing imports")
+        if not self.import_top or not self.import_end:
+            log_error("Import sections not defined in SceModuleInfo.")
+            return
 
-            # process imported variables, lookup by nid, add symbol
-            for i in range(num_vars):
-                nid_addr = var_nid_table_addr + i * 4
-                entry_addr = var_entry_table_addr + i * 4
-                nid_data = bv.read(nid_addr, 4)
-                entry_data = bv.read(entry_addr, 4)
-                if len(nid_data) < 4 or len(entry_data) < 4:
-                    continue
-                variable_nid = struct.unpack("<I", nid_data)[0]
-                variable_addr = struct.unpack("<I", entry_data)[0]
-                variable_name = self.lookup_nid_variable(library_nid, variable_nid, library_name)
-                #log_info(f"Importing Variable: {variable_name} - Var addr: {variable_addr}") #debug
-                self.add_data_symbol(bv, variable_addr, variable_name)
+        import_libs = self.decode_import_libraries()
+        for record in import_libs:
+            # Add structs to bn datatypes
+            self.add_struct(record["struct_name"], record["abs_addr"])
+
+        #Per-library resolution is pure CPU with no BinaryView dependency once
+        #the tables are read, so fan it out across a thread pool. The hot parts
+        #(mmap binary search, struct unpacking) run in C and overlap despite the
+        #GIL; results are folded back on this thread so counters stay exact.
+        if import_libs:
+            with ThreadPoolExecutor() as pool:
+                for funcs, data_vars, hits, misses in pool.map(self.resolve_import_library, import_libs):
+                    self.pending_functions.extend(funcs)
+                    self.pending_data_vars.extend(data_vars)
+                    self.stats["nid_hits"] += hits
+                    self.stats["nid_misses"] += misses
+
+    def resolve_import_library(self, import_lib):
+        """
+        Resolve one decoded import library's NID tables into (addr, name) symbol
+        lists. Thread-safe: touches only the read-only DB index, no BinaryView
+        or shared counters. Returns (functions, data vars, lookup hits, misses).
+        """
+        library_nid = import_lib["library_nid"]
+        library_name = import_lib["library_name"]
+        func_nids = import_lib["func_nid_table"]
+        func_entries = import_lib["func_entry_table"]
+        var_nids = import_lib["var_nid_table"]
+        var_entries = import_lib["var_entry_table"]
+        functions = []
+        data_vars = []
+        hits = 0
+        misses = 0
+
+        #whole-library fast path: if the DB provably doesn't know this library
+        #(bloom filter on the compiled DB, presence set on the dict indexes),
+        #skip the per-NID probes and go straight to placeholder names
+        if not self.shared_export_index:
+            if self.compiled_db:
+                library_known = self.compiled_db.may_contain_library(library_nid)
+            elif self.nid_lib_present is not None:
+                library_known = library_nid in self.nid_lib_present
+            else:
+                library_known = True
+            if not library_known:
+                for function_nid, function_stub_addr in zip(func_nids, func_entries):
+                    functions.append((function_stub_addr, f"{library_name}_{function_nid:08X}"))
+                for variable_nid, variable_addr in zip(var_nids, var_entries):
+                    data_vars.append((variable_addr, f"{library_name}_{variable_nid:08X}"))
+                return functions, data_vars, 0, len(functions) + len(data_vars)
+
+        for function_nid, function_stub_addr in zip(func_nids, func_entries):
+            function_name = None
+            #an export we resolved next door beats the generic DB name
+            if self.shared_export_index:
+                exported = self.shared_export_index.get((library_nid, function_nid))
+                if exported is not None:
+                    function_name = exported[0]
+            if function_name is None:
+                if self.compiled_db:
+                    function_name = self.compiled_db.lookup_function(library_nid, function_nid)
+                else:
+                    function_name = self.nid_func_index.get((library_nid, function_nid))
+            if function_name is None:
+                misses += 1
+                function_name = f"{library_name}_{function_nid:08X}"
+            else:
+                hits += 1
+            #log_info(f"Importing Function: {function_name}") #debug
+            functions.append((function_stub_addr, function_name))
+
+        for variable_nid, variable_addr in zip(var_nids, var_entries):
+            variable_name = None
+            if self.shared_export_index:
+                exported = self.shared_export_index.get((library_nid, variable_nid))
+                if exported is not None:
+                    variable_name = exported[0]
+            if variable_name is None:
+                if self.compiled_db:
+                    variable_name = self.compiled_db.lookup_variable(library_nid, variable_nid)
+                else:
+                    variable_name = self.nid_var_index.get((library_nid, variable_nid))
+            if variable_name is None:
+                misses += 1
+                variable_name = f"{library_name}_{variable_nid:08X}"
+            else:
+                hits += 1
+            #log_info(f"Importing Variable: {variable_name} - Var addr: {variable_addr}") #debug
+            data_vars.append((variable_addr, variable_name))
 
-            imports_offset += size
+        return functions, data_vars, hits, misses
 
 
 
@@ -489,59 +1189,107 @@ class VitaElf():
         """
         Lookup function name in the NID DB using library and function NIDs.
         """
-        #TODO: Figure out more efficient way, nested nightmare
-        if self.nid_database and "modules" in self.nid_database:
-            for module_name, module in self.nid_database["modules"].items():
-                if "libraries" in module:
-                    for lib_name, lib in module["libraries"].items():
-                        if lib.get("nid") == library_nid:
-                            functions = lib.get("functions", {})
-                            for func_name, nid in functions.items():
-                                if nid == function_nid:
-                                    return func_name
+        if self.compiled_db:
+            name = self.compiled_db.lookup_function(library_nid, function_nid)
+        else:
+            name = self.nid_func_index.get((library_nid, function_nid))
+        if name is not None:
+            self.stats["nid_hits"] += 1
+            return name
         #give default name if not found
+        self.stats["nid_misses"] += 1
         return f"{library_name}_{function_nid:08X}"
 
     def lookup_nid_variable(self, library_nid, variable_nid, library_name):
         """
-        Lookup variable name in the NID DB using library and function NIDs.
-        """
-        #TODO: Figure out more efficient way, nested nightmare
-        if self.nid_database and "modules" in self.nid_database:
-            for module_name, module in self.nid_database["modules"].items():
-                if "libraries" in module:
-                    for lib_name, lib in module["libraries"].items():
-                        if lib.get("nid") == library_nid:
-                            variables = lib.get("variables", {})
-                            for var_name, nid in variables.items():
-                                if nid == variable_nid:
-                                    return var_name
+        Lookup variable name in the NID DB using library and variable NIDs.
+        """
+        if self.compiled_db:
+            name = self.compiled_db.lookup_variable(library_nid, variable_nid)
+        else:
+            name = self.nid_var_index.get((library_nid, variable_nid))
+        if name is not None:
+            self.stats["nid_hits"] += 1
+            return name
         #give default name if not found
+        self.stats["nid_misses"] += 1
         return f"{library_name}_{variable_nid:08X}"
 
     def add_function_symbol(self, bv: BinaryView, addr: int, name: str):
         """
-        Create a void function at given addr with a variable number of arguments(To let BN try to determine args). Create a function symbol at addr with given name and add/define the imported function into the default ELF BinaryView.
+        Queue a function symbol for the batched apply pass in apply_symbols().
         """
-        if not bv.get_function_at(addr):
-            bv.create_user_function(addr)
-
+        self.pending_functions.append((addr, name))
 
-        #Setting imports to void and tell binary ninja to resolve variables.
-        #func_type = Type.function(Type.void(), [], variable_arguments=True)
+    def add_data_symbol(self, bv: BinaryView, addr: int, name: str):
+        """
+        Queue a data symbol for the batched apply pass in apply_symbols().
+        """
+        self.pending_data_vars.append((addr, name))
 
-        if self.sdk_hdr and name in self.sdk_hdr.functions:
-            func_param = self.sdk_hdr.functions[name].parameters
-            func_ret = self.sdk_hdr.functions[name].return_value
-            func_type = Type.function(func_ret, func_param, variable_arguments=False)
-        else:
-            func_type = Type.function(Type.void(), [], variable_arguments=True)
-        #func_type = Type.function(None, None, variable_arguments=True)
+    def apply_symbols(self, bv: BinaryView):
+        """
+        Apply all queued function and data symbols in one bulk pass with analysis
+        held, so thousands of definitions kick a single reanalysis instead of one
+        each. Called once after process_exports/process_imports have resolved
+        everything.
+        """
+        #In incremental mode only entries whose name differs from the symbol
+        #already at that address are touched; 99% unchanged means 99% skipped.
+        if self.incremental:
+            self.pending_functions = [(addr, name) for addr, name in self.pending_functions
+                                      if not self.symbol_unchanged(bv, addr, name)]
+            self.pending_data_vars = [(addr, name) for addr, name in self.pending_data_vars
+                                      if not self.symbol_unchanged(bv, addr, name)]
+            self.applied_structs = []  #structs were applied on the initial run
+
+        log_info(f"Applying {len(self.pending_functions)} function and {len(self.pending_data_vars)} data symbols")
+        self.stats["function_symbols"] += len(self.pending_functions)
+        self.stats["data_symbols"] += len(self.pending_data_vars)
+        bv.set_analysis_hold(True)
+        try:
+            for addr, name in self.pending_functions:
+                self.define_function_symbol(bv, addr, name)
+            #structs and plain vars go through one batched data pass
+            word_type = Type.int(4, sign=False)
+            data_entries = []
+            for name, addr in self.applied_structs:
+                struct_type = ensure_struct_type(bv, name)
+                if struct_type is not None:
+                    data_entries.append((addr, struct_type, None))
+            for addr, name in self.pending_data_vars:
+                data_entries.append((addr, word_type, name))
+            self.define_data_vars_batch(bv, data_entries)
+        finally:
+            bv.set_analysis_hold(False)
+        self.pending_functions = []
+        self.pending_data_vars = []
+        bv.update_analysis()
+
+    def symbol_unchanged(self, bv: BinaryView, addr: int, name: str):
+        """
+        True if the symbol already defined at addr carries the same name, i.e.
+        an incremental re-injection can skip it.
+        """
+        existing = bv.get_symbol_at(addr)
+        return existing is not None and existing.name == name
 
-        #Get the function pointer
+    def define_function_symbol(self, bv: BinaryView, addr: int, name: str):
+        """
+        Create a void function at given addr with a variable number of arguments(To let BN try to determine args). Create a function symbol at addr with given name and add/define the imported function into the default ELF BinaryView.
+        """
         func = bv.get_function_at(addr)
+        if func is None:
+            func = bv.create_user_function(addr)
+
+        func_type = self.func_type_map.get(name)
+        if func_type is not None:
+            #pull in only the header types this signature actually references
+            self.define_referenced_types(func_type)
+        else:
+            #Setting imports to void and tell binary ninja to resolve variables.
+            func_type = self.default_func_type
 
-        #set type to void with variables
         func.type = func_type
 
         symbol = Symbol(SymbolType.ImportedFunctionSymbol, addr, name)
@@ -549,47 +1297,222 @@ class VitaElf():
         #define as import, will need to add check for export but it appears to just be a color coding thing for our purposes.
         bv.define_imported_function(symbol, func)
 
-    def add_data_symbol(self, bv: BinaryView, addr: int, name: str):
+    def define_data_vars_batch(self, bv: BinaryView, entries):
+        """
+        Apply all queued data definitions — structs and plain variables — in one
+        sorted sweep. entries is a list of (addr, var_type, name or None).
+        Functions linear sweep mis-created over these addresses (data read as
+        instructions) are located by binary search against a single snapshot of
+        the function list and removed in bulk, then the symbols and data vars
+        are defined, instead of a get_functions_containing/remove_function/
+        define_data_var round trip per address.
         """
-        Create a data symbol at addr with given name and add/define the data variable into the default ELF BinaryView.
-        This will also check if a function was created(interpreted as instructions) at the data address and remove it if so.
+        if not entries:
+            return
+        entries.sort(key=lambda e: e[0])
+        funcs = sorted(bv.functions, key=lambda f: f.start)
+        starts = [func.start for func in funcs]
+        doomed = {}
+        for addr, _, _ in entries:
+            idx = bisect.bisect_right(starts, addr) - 1
+            if idx < 0:
+                continue
+            func = funcs[idx]
+            try:
+                if any(r.start <= addr < r.end for r in func.address_ranges):
+                    doomed[func.start] = func
+            except Exception:
+                continue
+        for func in doomed.values():
+            bv.remove_function(func)
+        for addr, var_type, name in entries:
+            if name is not None:
+                bv.define_user_symbol(Symbol(SymbolType.DataSymbol, addr, name))
+            bv.define_data_var(addr, var_type)
+
+    def add_struct(self, name, addr):
         """
-        symbol = Symbol(SymbolType.DataSymbol, addr, name)
-        bv.define_user_symbol(symbol)
+        Queue one of the structs.py types for application at addr during the
+        batched commit. The record doubles as the resolution-cache entry so a
+        cached replay re-applies the same structs without re-parsing.
+        """
+        self.applied_structs.append((name, addr))
 
-        # Binary Ninja likely mis-interpreted instructions(functions) at data_addr after linear sweep.
+    def resolution_cache_path(self):
+        """
+        Cache file for this module's resolved symbols. Keyed by dbg_fingerprint
+        (module_nid, unique per module build) plus the path+mtime of the DB and
+        header used, so a DB update naturally misses and re-resolves. Workspace
+        runs fold a hash of the shared export index into the key too, so names
+        resolved against sibling exports never replay into plain runs (or vice
+        versa, or across different module sets).
+        """
+        if getattr(self, "module_nid", None) is None:
+            return None
+        versions = []
+        for path in (self.nid_db_path, self.header_path):
+            if path:
+                try:
+                    versions.append(f"{path}:{os.path.getmtime(path)}")
+                except OSError:
+                    versions.append(path)
+        if self.shared_export_index:
+            index_items = sorted((lib, nid, value[0])
+                                 for (lib, nid), value in self.shared_export_index.items())
+            index_digest = hashlib.sha1(json.dumps(index_items).encode()).hexdigest()[:12]
+            versions.append(f"workspace:{index_digest}")
+        digest = hashlib.sha1("|".join(versions).encode()).hexdigest()[:12]
+        cache_dir = os.path.join(os.path.expanduser("~"), ".cache", "vita_loader", "resolved")
+        return os.path.join(cache_dir, f"{self.module_nid:08X}_{digest}.json")
+
+    def load_resolution_cache(self):
+        """
+        Replay a previously resolved symbol set for this exact module build.
+        Returns True on a hit, with the pending symbol lists, struct
+        applications, and entry point restored as if process_imports/exports ran.
+        """
+        cache_path = self.resolution_cache_path()
+        if not cache_path or not os.path.exists(cache_path):
+            return False
+        try:
+            with open(cache_path) as f:
+                cached = json.load(f)
+        except Exception as e:
+            log_info(f"Unreadable resolution cache, re-resolving: {e}")
+            return False
+        self.pending_functions = [tuple(entry) for entry in cached["functions"]]
+        self.pending_data_vars = [tuple(entry) for entry in cached["data_vars"]]
+        self.module_start_addr = cached.get("module_start_addr")
+        for name, addr in cached.get("structs", []):
+            self.add_struct(name, addr)
+        log_info(f"Replaying {len(self.pending_functions)} function and "
+                 f"{len(self.pending_data_vars)} data symbols from resolution cache")
+        return True
+
+    def save_resolution_cache(self):
+        """
+        Persist the resolved symbol set so re-opening this module (or meeting it
+        again in another dump) skips NID lookup and header matching entirely.
+        """
+        cache_path = self.resolution_cache_path()
+        if not cache_path:
+            return
         try:
-            rem_func = self.bv.get_functions_containing(addr)
-            self.bv.remove_function(rem_func[0])
-        except:
-            pass
-        bv.define_data_var(addr, Type.int(4, sign=False))
-
-    #There has to be a better pythonic way of doing this.
-    #Technically would be faster to read into overkill sized buffer and split at b"\x00".
+            os.makedirs(os.path.dirname(cache_path), exist_ok=True)
+            with open(cache_path, "w") as f:
+                json.dump({
+                    "functions": self.pending_functions,
+                    "data_vars": self.pending_data_vars,
+                    "structs": self.applied_structs,
+                    "module_start_addr": self.module_start_addr,
+                }, f)
+        except Exception as e:
+            log_info(f"Failed to write resolution cache: {e}")
+
+    def process_exidx_functions(self):
+        """
+        Seed function starts from the ARM exception index (.ARM.exidx).
+        parse_sce_module_info already gives us arm_exidx_top/end; each 8-byte
+        exidx entry begins with a prel31 offset to a real function start, so the
+        table enumerates authoritative boundaries without sweeping — and without
+        mistaking inline data for code. Returns the number of functions created.
+        """
+        if not getattr(self, "exidx_top", 0) or self.exidx_end <= self.exidx_top:
+            return 0
+        ph_offset = self.program_headers[0][1]
+        exidx_offset = self.exidx_top + ph_offset
+        num_entries = (self.exidx_end - self.exidx_top) // 8
+        if exidx_offset + num_entries * 8 > len(self.elf_data):
+            log_error(f"exidx table extends past end of file at 0x{exidx_offset:X}")
+            return 0
+
+        created = 0
+        for i in range(num_entries):
+            word0 = struct.unpack_from(f"{self.struct_endianness}I", self.elf_data, exidx_offset + i * 8)[0]
+            if word0 & 0x80000000:
+                continue  #bit31 set means not a prel31 offset, skip
+            #prel31: 31-bit signed offset relative to the entry's own address
+            delta = word0 - 0x80000000 if word0 & 0x40000000 else word0
+            entry_va = self.base_addr + self.exidx_top + i * 8
+            target = (entry_va + delta) & 0xFFFFFFFF
+            func_addr = target & 0xFFFFFFFE
+            if not self.bv.get_function_at(func_addr):
+                #bit0 of the resolved target is the Thumb bit; most Vita code is
+                #Thumb2, and a user function seeded on the wrong platform never
+                #gets corrected by later sweeps
+                plat = self.bv.platform
+                if target & 1:
+                    plat = plat.get_related_platform(Architecture['thumb2']) or plat
+                self.bv.create_user_function(func_addr, plat)
+                created += 1
+        log_info(f"exidx: seeded {created} function starts from {num_entries} entries")
+        return created
+
+    def read_word_table(self, bv: BinaryView, addr: int, count: int):
+        """
+        Read count little-endian u32s at addr with a single bv.read instead of
+        count tiny 4-byte API round-trips. A short read truncates at the last
+        whole word rather than failing the library.
+        """
+        if count <= 0 or not addr:
+            return ()
+        #file-backed addresses decode straight out of the mapped elf_data buffer
+        offset = self.va_to_offset(addr)
+        if offset is not None and offset + count * 4 <= len(self.elf_data):
+            return struct.unpack_from(f"{self.struct_endianness}{count}I", self.elf_data, offset)
+        data = bv.read(addr, count * 4)
+        whole_words = len(data) // 4
+        if whole_words < count:
+            log_error(f"Short table read at 0x{addr:X}: got {whole_words}/{count} entries")
+        return struct.unpack(f"{self.struct_endianness}{whole_words}I", data[:whole_words * 4])
+
     def read_string_at(self, bv: BinaryView, addr: int):
         """
         Reads a C(null-terminated) string from the given addr.
+        Fetches 256-byte chunks and splits at the first NUL instead of one
+        bv.read per byte, extending the chunk for longer strings. File-backed
+        addresses are served straight from the mapped elf_data buffer.
         """
+        chunk_size = 256
+        offset = self.va_to_offset(addr)
         s = b""
         while True:
-            c = bv.read(addr, 1)
-            if c == b"\x00" or not c:
+            if offset is not None:
+                chunk = bytes(self.elf_data[offset:offset + chunk_size])
+                offset += len(chunk)
+            else:
+                chunk = bv.read(addr, chunk_size)
+                addr += len(chunk)
+            if not chunk:
+                break
+            nul = chunk.find(b"\x00")
+            if nul != -1:
+                s += chunk[:nul]
                 break
-            s += c
-            addr += 1
+            s += chunk
         return s.decode("ascii", errors="ignore")
 
     def clean_data_segs(self):
         '''
         With the last Linear Sweep run, Binary Ninja mis-identifies lots of data segments past import_end as instructions(functions). In all Vita binaries tested, everything past the import_end(SceModuleInfo.stub_end) is data.
         This will remove/undefine those functions.
+        The function list is already sorted by start address, so the cutoff is a
+        binary search and the removals are committed as one batch under a single
+        analysis hold instead of one reanalysis per removal.
         '''
         end_imports = self.base_addr + self.import_end
-        funcs = self.bv.functions
-        for func in funcs:
-            if func.start > end_imports:
+        funcs = list(self.bv.functions)
+        starts = [func.start for func in funcs]
+        doomed = funcs[bisect.bisect_right(starts, end_imports):]
+        if not doomed:
+            return
+        self.bv.set_analysis_hold(True)
+        try:
+            for func in doomed:
                 self.bv.remove_function(func)
+        finally:
+            self.bv.set_analysis_hold(False)
+        self.bv.update_analysis()
 
 
 def sweep_before_load(bv):
@@ -598,32 +1521,110 @@ def sweep_before_load(bv):
     Until a more clever approach is realized, this will solve two issues:
     1. Loading the plugin and injecting addresses during the initial analysis/linsweep causes mis-alignment issues.
     2. There appears to be an issue with binaries using mixed arm & thumb instruction sets, the first Linear Sweep run does okay but misses many functions(typically on the order of a few thousand). The second run does better and the third will find and create all of them, with the caveat that some inline data will be interpreted as instructions, causing a few non-functions to be represented as mis-aligned functions.
-    This function will run linear sweep in a new thread for a max of n times or until no new functions are created.
+    This function will run linear sweep in a new thread until the function count within the text range stabilizes, for a max of n times.
+    SceModuleInfo is parsed up front so convergence is judged only against the region below stub_end; junk functions the sweep creates in the trailing data region are pruned between runs instead of being re-swept (and later deleted) five times over.
 '''
-    def n_linearsweep():
-        func_cnt = 0    #function count
-        i = 0           #current sweep iteration
-        n_max = 5       #max linear sweep runs, stabilizes on 3-4 typically
-
-        while i < n_max:
-            bv.update_analysis_and_wait()           #wait for default analysis
-            bv.add_analysis_option("linearsweep")   #add linearsweep
-            bv.update_analysis_and_wait()           #run linearsweep and wait
-
-            cur_func_cnt = len(list(bv.functions))  #get current function count
-            if cur_func_cnt == func_cnt:
-                log_info(f"No new functions created at linearsweep: {i}")
-                break
+    VitaLoadTask(bv).start()
 
-            func_cnt = cur_func_cnt
-            i += 1
 
-        if i >= n_max:
-            log_info(f"ran {i} linear sweeps, potentially more functions undiscovered")
+def reinject_symbols(bv):
+    '''
+    Incremental re-injection after a NID DB update: the function landscape in
+    the .bndb is already analyzed, so the sweep loop is skipped entirely and
+    only symbols whose resolved name differs from what's already defined get
+    touched. Re-resolving a large eboot drops to seconds.
+    '''
+    VitaLoadTask(bv, incremental=True).start()
 
-        #Switch back to main UI event thread and run plugin
-        execute_on_main_thread(lambda: VitaElf(bv).load_vita_symbols())
 
-    #Run linear sweep analysis in new thread.
-    threading.Thread(target=n_linearsweep).start()
+class VitaLoadTask(BackgroundTaskThread):
+    '''
+    Background pipeline task: reports which phase is running (sweep N of M,
+    resolving, committing) in the status bar and honors cancellation between
+    phases, so a mistaken multi-minute load can be aborted without killing BN.
+    '''
+    def __init__(self, bv, incremental=False):
+        super().__init__("VitaELF: starting...", can_cancel=True)
+        self.bv = bv
+        self.vita = VitaElf(bv)
+        self.vita.incremental = incremental
+
+    def run(self):
+        if not self.vita.incremental:
+            run_linear_sweeps(self.bv, self.vita, task=self)
+            if self.cancelled:
+                log_info("VitaELF load cancelled during sweep")
+                return
+        self.progress = "VitaELF: resolving symbols"
+        if not self.vita.resolve_symbols():
+            return
+        if self.cancelled:
+            log_info("VitaELF load cancelled before commit")
+            return
+        self.progress = (f"VitaELF: applying {len(self.vita.pending_functions)} function, "
+                         f"{len(self.vita.pending_data_vars)} data symbols")
+        #only the final batched mutation bounces to the UI event thread
+        execute_on_main_thread(lambda: self.vita.commit_symbols())
+
+
+def run_linear_sweeps(bv, vita, task=None):
+    '''
+    Run the sweep-until-stable loop for the given VitaElf. Must be called off
+    the UI thread (or headlessly) since it blocks on update_analysis_and_wait.
+    Shared between the UI path (VitaLoadTask) and the headless batch mode; when
+    a task is given, its progress is updated per sweep and cancellation is
+    checked between sweeps.
+    '''
+    #Parse the module info first so we know where text ends. Everything past
+    #stub_end is inline data in every Vita binary tested, clean_data_segs
+    #would strip it at the end anyway.
+    text_end = None
+    exidx_seeded = 0
+    try:
+        vita.parse_elf()
+        vita.parse_sce_module_info()
+        text_end = vita.base_addr + vita.import_end
+        #Seed authoritative function starts from the exception index before
+        #any sweeping; with real boundaries in place the sweeps only have to
+        #fill gaps and converge much sooner.
+        exidx_seeded = vita.process_exidx_functions()
+    except Exception as e:
+        log_info(f"Could not pre-parse SceModuleInfo, sweeping whole image: {e}")
+
+    def in_range_func_cnt():
+        if text_end is None:
+            return len(list(bv.functions))
+        return sum(1 for f in bv.functions if f.start <= text_end)
+
+    func_cnt = 0    #function count within the text range
+    i = 0           #current sweep iteration
+    #max linear sweep runs; with exidx-seeded boundaries the mixed arm/thumb
+    #misses that needed 3-4 sweeps are already covered, so 2 suffices
+    n_max = 2 if exidx_seeded else 5
+
+    while i < n_max:
+        if task is not None:
+            if task.cancelled:
+                return
+            task.progress = f"VitaELF: linear sweep {i + 1} of {n_max} ({func_cnt} functions)"
+
+        bv.update_analysis_and_wait()           #wait for default analysis
+        bv.add_analysis_option("linearsweep")   #add linearsweep
+        bv.update_analysis_and_wait()           #run linearsweep and wait
+
+        if text_end is not None:
+            #prune mis-identified data-region 'functions' now so the next
+            #sweep doesn't spend its time re-analyzing past the cutoff
+            vita.clean_data_segs()
+
+        cur_func_cnt = in_range_func_cnt()      #get current in-range function count
+        if cur_func_cnt == func_cnt:
+            log_info(f"No new functions created at linearsweep: {i}")
+            break
+
+        func_cnt = cur_func_cnt
+        i += 1
+
+    if i >= n_max:
+        log_info(f"ran {i} linear sweeps, potentially more functions undiscovered")
 